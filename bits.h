@@ -42,7 +42,7 @@ class BitPointer
    public:
       BitPointer() { m_byteptr = nullptr ; m_bitnumber = 0 ; }
       BitPointer(const void *ptr) { m_byteptr = (const uint8_t*)ptr ; m_bitnumber = 0 ; }
-      BitPointer(const BitPointer &ptr) { m_byteptr = ptr.m_byteptr ; m_bitnumber = ptr.m_bitnumber ; }
+      BitPointer(const BitPointer &ptr) = default ;
       BitPointer(const BitPointer *ptr) { m_byteptr = ptr->m_byteptr ; m_bitnumber = ptr->m_bitnumber ; }
       ~BitPointer() = default ;
 
@@ -58,6 +58,10 @@ class BitPointer
       uint32_t prevBit() { retreat1() ; return getBit() ; }
       uint32_t prevBits(unsigned num_bits) ;
       uint32_t prevBitsReversed(unsigned num_bits) ;
+      // the up to 32 bits preceding the pointer, with the nearest in the
+      //   LSB, so that the low N bits are the value prevBitsReversed(N)
+      //   would return
+      uint32_t precedingBitsReversed(unsigned num_bits) const ;
 
       // manipulators
       void advance(unsigned num_bits)
@@ -86,9 +90,7 @@ class BitPointer
 	 }
       void retreatBytes(size_t num_bytes) { m_byteptr -= num_bytes ; }
       void retreatToByte() { m_bitnumber = 0 ; }
-      BitPointer &operator = (const BitPointer &old)
-	 { m_byteptr = old.m_byteptr ; m_bitnumber = old.m_bitnumber ;
-	   return *this ; }
+      BitPointer &operator = (const BitPointer &old) = default ;
       BitPointer &operator += (unsigned num_bits)
 	 { advance(num_bits) ; return *this ; }
       BitPointer &operator -= (unsigned num_bits)
@@ -0,0 +1,86 @@
+/****************************** -*- C++ -*- *****************************/
+/*									*/
+/*	ZipRecover: extract text from corrupted zip/gzip streams	*/
+/*	by Ralf Brown / Carnegie Mellon University			*/
+/*									*/
+/*  File: deflenc.h - simple DEFLATE encoder for benchmarks		*/
+/*  Version:  1.10beta				       			*/
+/*  LastEdit: 2026-10-18						*/
+/*									*/
+/*  (c) Copyright 2026 Carnegie Mellon University			*/
+/*      This program is free software; you can redistribute it and/or   */
+/*      modify it under the terms of the GNU General Public License as  */
+/*      published by the Free Software Foundation, version 3.           */
+/*                                                                      */
+/*      This program is distributed in the hope that it will be         */
+/*      useful, but WITHOUT ANY WARRANTY; without even the implied      */
+/*      warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR         */
+/*      PURPOSE.  See the GNU General Public License for more details.  */
+/*                                                                      */
+/*      You should have received a copy of the GNU General Public       */
+/*      License (file COPYING) along with this program.  If not, see    */
+/*      http://www.gnu.org/licenses/                                    */
+/*                                                                      */
+/************************************************************************/
+
+#ifndef __DEFLENC_H_INCLUDED
+#define __DEFLENC_H_INCLUDED
+
+#include <cstdint>
+#include <cstdlib>
+#include "framepac/memory.h"
+
+/************************************************************************/
+/*	Manifest Constants						*/
+/************************************************************************/
+
+// how many bytes of input go into each packet by default
+#define DEFAULT_ENCODER_PACKET 16384
+
+/************************************************************************/
+/*	Type definitions						*/
+/************************************************************************/
+
+// a small, self-contained DEFLATE compressor (greedy LZ77 matching and
+//   dynamic Huffman packets), used to build repeatable test streams from
+//   plain text without depending on an external compression library
+
+class DeflateEncoder
+   {
+   public:
+      DeflateEncoder(size_t packet_bytes = DEFAULT_ENCODER_PACKET) ;
+      ~DeflateEncoder() = default ;
+
+      // accessors
+      const uint8_t* stream() const { return m_output.begin() ; }
+      size_t streamSize() const { return m_outsize ; }
+      size_t packetCount() const { return m_packets ; }
+
+      // compress 'size' bytes into a raw DEFLATE stream, replacing any
+      //   previous output
+      bool encode(const uint8_t* data, size_t size) ;
+
+   protected:
+      bool putBits(uint32_t value, unsigned count) ;
+      bool putCode(uint32_t code, unsigned length) ;
+      bool flush() ;
+      size_t findMatch(const uint8_t* data, size_t pos, size_t size, size_t& distance) const ;
+      void insertString(const uint8_t* data, size_t pos, size_t size) ;
+      bool encodePacket(const uint8_t* data, size_t start, size_t end, bool last) ;
+      bool writePacket(const uint32_t* tokens, size_t num_tokens, bool last) ;
+
+   private:
+      Fr::NewPtr<uint8_t>  m_output ;
+      Fr::NewPtr<int32_t>  m_head ;	 // most recent position with each hash
+      Fr::NewPtr<int32_t>  m_prev ;	 // previous position with same hash
+      size_t		   m_outsize ;
+      size_t		   m_outalloc ;
+      size_t		   m_packet_bytes ;
+      size_t		   m_packets ;
+      uint64_t		   m_bitbuf ;
+      unsigned		   m_bitcount ;
+   } ;
+
+#endif /* !__DEFLENC_H_INCLUDED */
+
+// end of file deflenc.h //
@@ -0,0 +1,75 @@
+/****************************** -*- C++ -*- *****************************/
+/*									*/
+/*	ZipRecover: extract text from corrupted zip/gzip streams	*/
+/*	by Ralf Brown / Carnegie Mellon University			*/
+/*									*/
+/*  File: extents.h - data extents of sparse input files		*/
+/*  Version:  1.10beta				       			*/
+/*  LastEdit: 2026-10-18						*/
+/*									*/
+/*  (c) Copyright 2026 Carnegie Mellon University			*/
+/*      This program is free software; you can redistribute it and/or   */
+/*      modify it under the terms of the GNU General Public License as  */
+/*      published by the Free Software Foundation, version 3.           */
+/*                                                                      */
+/*      This program is distributed in the hope that it will be         */
+/*      useful, but WITHOUT ANY WARRANTY; without even the implied      */
+/*      warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR         */
+/*      PURPOSE.  See the GNU General Public License for more details.  */
+/*                                                                      */
+/*      You should have received a copy of the GNU General Public       */
+/*      License (file COPYING) along with this program.  If not, see    */
+/*      http://www.gnu.org/licenses/                                    */
+/*                                                                      */
+/************************************************************************/
+
+#ifndef __EXTENTS_H_INCLUDED
+#define __EXTENTS_H_INCLUDED
+
+#include <sys/types.h>
+#include "framepac/smartptr.h"
+
+/************************************************************************/
+/*	Type definitions						*/
+/************************************************************************/
+
+// the ranges of a (possibly sparse) input file which actually contain
+//   data; everything between two extents is a hole which reads as zeros
+//   and need not be scanned or faulted in
+
+class DataExtents
+   {
+   public:
+      DataExtents(off_t length = 0) ;
+      ~DataExtents() = default ;
+
+      // modifiers
+      bool scan(int fd, off_t length, off_t base = 0) ;
+      void clear() ;
+
+      // accessors
+      size_t numExtents() const { return m_count ; }
+      off_t extentStart(size_t n) const { return m_starts[n] ; }
+      off_t extentEnd(size_t n) const { return m_ends[n] ; }
+      off_t length() const { return m_length ; }
+      off_t holeBytes() const ;
+      bool sparse() const ;
+      bool inHole(off_t offset) const ;
+      bool firstHole(off_t start, off_t end, off_t& hole_start, off_t& hole_end) const ;
+      bool lastHole(off_t start, off_t end, off_t& hole_start, off_t& hole_end) const ;
+
+   protected:
+      bool append(off_t start, off_t end) ;
+      size_t extentAfter(off_t offset) const ;
+
+   private:
+      Fr::NewPtr<off_t> m_starts ;
+      Fr::NewPtr<off_t> m_ends ;
+      size_t            m_count { 0 } ;
+      size_t            m_alloc { 0 } ;
+      off_t             m_length { 0 } ;
+   } ;
+
+#endif /* !__EXTENTS_H_INCLUDED */
+
+// end of file extents.h //
@@ -61,7 +61,10 @@
 #define ZIPREC_VERSION "1.10alpha"
 
 #define LANGMODEL_SIGNATURE "ZipRec Language Model Data\n"
-#define LANGMODEL_FORMAT_VERSION 3
+#define LANGMODEL_FORMAT_VERSION 4
+// version 3 models hold n-gram tries whose child bitmaps were written
+//   with a faulty mask, and must be rebuilt
+#define LANGMODEL_FORMAT_ALIASED_TRIES 3
 
 // set the verbosity levels at which various types of data are dumped
 #define VERBOSITY_PROGRESS 1
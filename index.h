@@ -36,8 +36,6 @@
 
 class WildcardIndex
    {
-   public:
-      typedef Fr::NewPtr<uint32_t> LocPtr ;
    public:
       WildcardIndex(const DecodedByte *bytes, size_t num_bytes, unsigned max_ref) ;
       ~WildcardIndex() = default ;
@@ -45,14 +43,17 @@ class WildcardIndex
       // accessors
       unsigned indexSize() const { return  m_indexsize ; }
       uint32_t location(unsigned wildcard, unsigned index) const
-         { return (wildcard < indexSize() && index < m_counts[wildcard]) 
-	       ? m_locations[wildcard][index] : UINT32_MAX ; }
-      const uint32_t *locations(unsigned wildcard) const { return m_locations[wildcard].get() ; }
-      unsigned numLocations(unsigned wildcard) const { return m_counts[wildcard] ; }
+         { return (wildcard < indexSize() && index < numLocations(wildcard))
+	       ? m_locations[m_offsets[wildcard] + index] : UINT32_MAX ; }
+      const uint32_t *locations(unsigned wildcard) const { return m_locations + m_offsets[wildcard] ; }
+      unsigned numLocations(unsigned wildcard) const
+	 { return m_offsets[wildcard+1] - m_offsets[wildcard] ; }
 
    private:
-      Fr::NewPtr<uint32_t>  m_counts ;
-      Fr::NewPtr<LocPtr>    m_locations ;
+      // the locations of wildcard W are m_locations[m_offsets[W]] through
+      //   m_locations[m_offsets[W+1]-1]
+      Fr::NewPtr<uint32_t>  m_offsets ;
+      Fr::NewPtr<uint32_t>  m_locations ;
       unsigned              m_indexsize ;
    } ;
 
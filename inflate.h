@@ -88,6 +88,7 @@ enum PacketType
 
 class LocationList ;
 class FileInformation ;
+class DataExtents ;
 
 //----------------------------------------------------------------------
 
@@ -185,6 +186,10 @@ class DeflatePacketDesc
 
 bool valid_packet_header(const char* buffer, bool deflate64, bool allow_fixedHuff) ;
 
+unsigned triage_stream(const char* stream_start, const char* stream_end, size_t base_offset,
+		       bool known_start, bool deflate64, bool known_end, const DataExtents* extents,
+		       bool& valid_header) ;
+
 bool recover_stream(const LocationList* start_sig, const LocationList* end_sig,
 		    const class ZipRecParameters&, const FileInformation* fileinfo,
 		    const char* filename_hint, uint32_t original_size_hint,
@@ -54,6 +54,8 @@ class WordLengthModel
       void scale(double scale_factor) ;
       void addDelim(size_t len) ;
       void addWord(size_t len) ;
+      void removeDelim(size_t len) ;
+      void removeWord(size_t len) ;
       void addWords(const unsigned char *buf, size_t buflen) ;
       const unsigned char *addWords(const unsigned char *buf, size_t buflen,
 				    size_t maxlen) ;
@@ -84,6 +86,7 @@ class WordLengthModel
       double averageDelim() const
 	 { return totalDelimLength() / (double)totalDelims() ; }
       double similarity(const WordLengthModel *other) const ;
+      bool isDelimiter(const unsigned char *buf) const ;
 
       // I/O
       const unsigned char *skipToDelim(const unsigned char *buf, size_t buflen) const ;
@@ -108,6 +108,8 @@ class BidirModel
 
    protected:
       void setLengths() ;
+      static void scoreMatches(const LangIDPackedTrie *trie, const PackedTrieMatch *matches, unsigned matchcount,
+			       size_t num_bytes, ZRScore *scores, double weight) ;
       static bool computeScore(const LangIDPackedTrie *trie, uint8_t *key, size_t num_bytes,
 			       const WildcardSet **context_wildcards,
 			       ZRScore *scores, double weight) ;
@@ -125,6 +127,50 @@ class BidirModel
       double		 m_center_factor ;
       size_t		 m_forward_len ;
       size_t		 m_reverse_len ;
+
+      friend class RollingContext ;
+   } ;
+
+//----------------------------------------------------------------------
+// computes the same one-sided context scores as BidirModel::computeScores,
+//   but keeps a trie cursor for every n-gram start in the window so that
+//   moving on to a nearby wildcard only needs to extend the cursors by the
+//   bytes in between, one trie step per cursor per byte, instead of
+//   walking every n-gram from the root again.  The window slides forward
+//   when successive forward contexts are for increasing offsets, and
+//   successive reverse contexts for decreasing offsets.  Contexts which
+//   contain another wildcard or a discontinuity are passed on to
+//   BidirModel::computeScores.
+
+class RollingContext
+   {
+   public:
+      RollingContext(const BidirModel& model, bool reverse, size_t num_bytes) ;
+      ~RollingContext() = default ;
+
+      bool computeScores(const DecodedByte *file_buffer, size_t offset, size_t max_bytes,
+			 const WildcardCollection *context_wildcards,
+			 ZRScore *scores, double weight, ContextFlags &context_flags) ;
+
+   protected:
+      const DecodedByte& byteAt(const DecodedByte *file_buffer, size_t pos) const
+	 { return file_buffer[m_reverse ? m_numbytes - pos : pos] ; }
+      uint32_t& cursor(unsigned model, size_t start)
+	 { return m_cursors[model * m_window + start % m_window] ; }
+      void advance(const DecodedByte *file_buffer, size_t start, size_t end) ;
+      unsigned applyModel(unsigned model, double model_weight, size_t min_len, size_t end, size_t max_bytes,
+			  double weight, ZRScore *scores, ContextFlags &context_flags) ;
+
+   private:
+      const BidirModel&       m_model ;
+      const LangIDPackedTrie* m_tries[2] ;	// file model, global model
+      Fr::NewPtr<uint32_t>    m_cursors ;	// ring buffer of node indices per model
+      size_t		      m_numbytes ;
+      size_t		      m_window ;
+      size_t		      m_first { 0 } ;	// oldest n-gram start with a cursor
+      size_t		      m_end { 0 } ;	// position just past the last byte consumed
+      bool		      m_reverse ;
+      bool		      m_valid { false } ;
    } ;
 
 /************************************************************************/
@@ -26,6 +26,7 @@
 #ifndef __PARTIAL_H_INCLUDED
 #define __PARTIAL_H_INCLUDED
 
+#include <atomic>
 #include "huffman.h"
 #include "framepac/byteorder.h"
 #include "framepac/memory.h"
@@ -65,6 +66,12 @@
 #define HYP_NOT_FOUND UINT_MAX
 #define CODE_HYP_BUCKET_SIZE 4
 #define CODE_HYP_BUCKETS ((LIT_SYMBOLS / CODE_HYP_BUCKET_SIZE) + 1)
+// a tree which adds at most this many codes to its parent stores just the
+//   added codes, and refers to the parent for the rest
+#define MAX_DELTA_CODES 4
+// how many trees stored as deltas may be chained before one stores its
+//   full code set again; this bounds the cost of reading a code
+#define MAX_DELTA_DEPTH 8
 
 /************************************************************************/
 /************************************************************************/
@@ -134,9 +141,9 @@ class CodeHypothesis
       bool isLiteral() const
 	 { return (m_value.load() & LITERAL_MASK) != 0 ; }
       unsigned length() const { return m_length ; }
-      unsigned extraBits() const { return m_extra ; }
-         // note that to support DEFLATE64, the above result needs to be
-         //   passed through a lookup that converts 15 to 16
+      // m_extra only has room for 15, which is never a valid count, so
+      //   it stands in for DEFLATE64's 16
+      unsigned extraBits() const { return m_extra == 15 ? MAX_LENGTH_EXTRABITS64 : m_extra ; }
       uint32_t hashValue() const { return m_value.load() ^ (m_length << 15) ^ (m_extra << 18) ; }
          // (the above generates a 22-bit hash code)
 
@@ -150,7 +157,7 @@ class CodeHypothesis
 	       code |= LITERAL_MASK ;
 	       }
 	    else
-	       m_extra = extra ;  // note: for DEFLATE64, 16 must be mapped to 15!
+	       setExtraBits(extra) ;
 	    m_value.store(code) ;
 	 }
       void setCode(unsigned code)
@@ -169,8 +176,7 @@ class CodeHypothesis
       void setLength(unsigned len) { m_length = len ; }
       void setExtraBits(unsigned extra)
 	 {
-	    m_extra = extra ; 
-         // note that to support DEFLATE64, 'extra' above must first  be passed through a lookup which maps 16 to 15
+	    m_extra = (extra == MAX_LENGTH_EXTRABITS64) ? 15 : extra ;
 	 }
    private:
       static constexpr unsigned CODE_MASK = 0x7FFF ;
@@ -193,15 +199,37 @@ class HuffmanTreeHypothesis
       void initLeftmost() ;
       void initRightmost() ;
       void computeHashCode() ;
+      void computeHashCode(const CodeHypothesis *codes) ;
+      void computeKraftSum(const CodeHypothesis *codes) ;
+      void addToKraftSum(unsigned length)
+	 { m_kraft_used += (1U << (MAX_BITLENGTH - length)) ; m_length_counts[length]++ ; }
       unsigned augmentTree(HuffmanCode code, unsigned length,
-			   unsigned extra,
-			   CodeHypothesis *&augmented) const ;
+			   unsigned extra, CodeHypothesis *new_codes,
+			   unsigned &run_start, unsigned &run_length) const ;
+      const CodeHypothesis &codeAt(unsigned index) const
+	 { const HuffmanTreeHypothesis *tree = this ;
+	   while (!tree->m_codes)
+	      {
+	      // follow the chain of deltas until we reach the tree which
+	      //   holds the requested code
+	      if (index >= tree->m_delta_pos)
+		 {
+		 if (index < tree->m_delta_pos + tree->m_delta_count)
+		    return tree->m_delta[index - tree->m_delta_pos] ;
+		 index -= tree->m_delta_count ;
+		 }
+	      tree = tree->m_base ;
+	      }
+	   return tree->m_codes[index] ; }
+      void copyCodes(CodeHypothesis *dest) const ;
+      const CodeHypothesis *codesView(CodeHypothesis *scratch) const ;
    public:
       void *operator new(size_t) { return allocator->allocate() ; }
       void operator delete(void *blk) { allocator->release(blk) ; }
 
       HuffmanTreeHypothesis(unsigned max_codes) ;
-      HuffmanTreeHypothesis(const HuffmanTreeHypothesis *orig, CodeHypothesis *codes, unsigned num_codes) ;
+      HuffmanTreeHypothesis(HuffmanTreeHypothesis *orig, const CodeHypothesis *new_codes, unsigned num_codes,
+			    unsigned run_start, unsigned run_length) ;
       ~HuffmanTreeHypothesis() ;
 
       // utility
@@ -211,9 +239,7 @@ class HuffmanTreeHypothesis
 	 { return (code << (MAX_BITLENGTH - length)) ; }
 
       // accessors
-      bool good() const { return m_codes != nullptr ; }
-      HuffmanTreeHypothesis *next() const { return m_next ; }
-      HuffmanTreeHypothesis *prev() const { return m_prev ; }
+      bool good() const { return m_codes != nullptr || m_base != nullptr ; }
       const HuffmanTreeHypothesis *parent() const { return m_parent ; }
       class TreeDirectory *treeDirectory() const ;
       unsigned symbolCount() const { return m_used ; }
@@ -224,21 +250,24 @@ class HuffmanTreeHypothesis
       unsigned maxCodeLength() const ;
       unsigned maxCodes() const { return m_maxcodes ; }
       unsigned requiredLeaves() const ;
+      double kraftSlack() const ; // fraction of code space not yet used
+      unsigned codesOfLength(unsigned length) const { return m_length_counts[length] ; }
+      bool roomForNewCode(unsigned length) const ;
 
       bool sameTree(const HuffmanTreeHypothesis *other) const ;
       bool isEOD(HuffmanCode code, unsigned length) const
 	 { return canonicalized(code,length) == m_EOD ; }
       bool isLiteral(unsigned index) const
-	 { return m_codes[index].isLiteral() ; }
+	 { return codeAt(index).isLiteral() ; }
       unsigned codeLength(unsigned index) const
-	 { return m_codes[index].length() ; }
+	 { return codeAt(index).length() ; }
       unsigned canonicalCodeValue(unsigned index) const
-	 { return m_codes[index].code() ; }
+	 { return codeAt(index).code() ; }
       HuffmanCode codeValue(unsigned index) const
-	 { return (m_codes[index].code()
+	 { return (codeAt(index).code()
 		   >> (MAX_BITLENGTH - codeLength(index))) ; }
       unsigned extraBits(unsigned index) const
-	 { return m_codes[index].extraBits() ; }
+	 { return codeAt(index).extraBits() ; }
       unsigned extrabitPredecessors(unsigned extra) const ;
       unsigned extrabitSuccessors(unsigned extra) const ;
       unsigned findCode(HuffmanCode code, unsigned len) const ;
@@ -249,13 +278,15 @@ class HuffmanTreeHypothesis
       bool tooManyLeaves(HuffmanCode code, unsigned length) const ;
       bool consistentWithTree(HuffmanCode code, unsigned length,
 			      unsigned extra, bool &present) const ;
+      // the half-open range [lo,hi) of codes of each permitted length
+      //   which fit between the known leaves of adjacent lengths
+      void codeBounds(unsigned lo[MAX_BITLENGTH+1],
+		      unsigned hi[MAX_BITLENGTH+1]) const ;
 
       // modifiers
       void addReference() { m_refcount++ ; }
       void removeReference() ;
-
-      void setNext(HuffmanTreeHypothesis *n) { m_next = n ; }
-      void setPrev(HuffmanTreeHypothesis *p) { m_prev = p ; }
+      uint32_t dropReference() { return --m_refcount ; } // caller handles deletion
 
       void setMinBitLength(unsigned len)
 	 { m_minlength = len < 1 ? 1 : (len <= m_maxlength) ? len : m_maxlength ;}
@@ -276,14 +307,22 @@ class HuffmanTreeHypothesis
    private:
       static Fr::SmallAlloc *allocator ;
       static Fr::SmallAlloc *code_allocators[CODE_HYP_BUCKETS+1] ;
-      static size_t          code_alloc_used[CODE_HYP_BUCKETS+1] ;
+      static std::atomic<size_t> code_alloc_used[CODE_HYP_BUCKETS+1] ;
 
-      HuffmanTreeHypothesis *m_next ;
-      HuffmanTreeHypothesis *m_prev ;
       const HuffmanTreeHypothesis *m_parent ;
-      CodeHypothesis        *m_codes ;
+      // the full set of codes, or null if the tree is stored as a run of
+      //   codes inserted into the (referenced) base tree; neither changes
+      //   once the tree has been built
+      CodeHypothesis	    *m_codes ;
+      HuffmanTreeHypothesis *m_base ;
+      CodeHypothesis	     m_delta[MAX_DELTA_CODES] ;
+      uint16_t		     m_delta_pos ;
+      uint8_t		     m_delta_count ;
+      uint8_t		     m_delta_depth ;	// number of deltas chained below this tree
       uint32_t		     m_hashcode ;
-      uint32_t		     m_refcount ;
+      uint32_t		     m_kraft_used ; // code space used, in units of 2^-MAX_BITLENGTH
+      uint16_t		     m_length_counts[MAX_BITLENGTH+1] ;
+      std::atomic<uint32_t>  m_refcount ;
       HuffmanCode	     m_EOD ;
       HuffmanCode	     m_leftmost[MAX_BITLENGTH+2] ;
       HuffmanCode	     m_rightmost[MAX_BITLENGTH+1] ;
@@ -302,14 +341,12 @@ class HuffmanHypothesis : public Fr::Object
    public:
       void *operator new(size_t) { return allocator.allocate() ; }
       void operator delete(void *blk) { allocator.release(blk) ; }
-      HuffmanHypothesis(const BitPointer &pos) ;
+      HuffmanHypothesis(const BitPointer &pos, size_t bitcount = 0) ;
       HuffmanHypothesis(const HuffmanHypothesis*, const BitPointer& pos, size_t extension_len) ;
       ~HuffmanHypothesis() ;
 
       // accessors
       HuffmanHypothesis *next() const { return m_next ; }
-      HuffmanHypothesis *dirNext() const { return m_dirnext ; }
-      HuffmanHypothesis *dirPrev() const { return m_dirprev ; }
       bool inBackReference() const { return m_in_backref ; }
       size_t bitCount() const { return m_bitcount ; }
       size_t minBitLength() const { return m_litcodes->minimumBitLength() ; }
@@ -321,6 +358,10 @@ class HuffmanHypothesis : public Fr::Object
       const BitPointer *startPosition() const { return &m_startpos ; }
       uint32_t hashCode() const
 	 { return m_litcodes->hashCode() ^ m_distcodes->hashCode() ; }
+      unsigned codeCount() const
+	 { return m_litcodes->symbolCount() + m_distcodes->symbolCount() ; }
+      double kraftSlack() const
+	 { return m_litcodes->kraftSlack() + m_distcodes->kraftSlack() ; }
       HuffmanCode lastLiteral() const { return m_lastliteral ; }
       unsigned lastLiteralLength() const { return m_lastlitlength ; }
       unsigned lastLiteralRepeat() const { return m_lastlitcount ; }
@@ -337,11 +378,13 @@ class HuffmanHypothesis : public Fr::Object
 				 unsigned extra_bits) const ;
       bool consistentDistance(HuffmanCode code, unsigned dist_bits,
 			      unsigned extra_bits) const ;
+      void literalBounds(unsigned lo[MAX_BITLENGTH+1], unsigned hi[MAX_BITLENGTH+1]) const
+	 { m_litcodes->codeBounds(lo,hi) ; }
+      void distanceBounds(unsigned lo[MAX_BITLENGTH+1], unsigned hi[MAX_BITLENGTH+1]) const
+	 { m_distcodes->codeBounds(lo,hi) ; }
 
       // modifiers
       void setNext(HuffmanHypothesis *nxt) { m_next = nxt ; }
-      void setDirNext(HuffmanHypothesis *nxt) { m_dirnext = nxt ; }
-      void setDirPrev(HuffmanHypothesis *prv) { m_dirprev = prv ; }
       void inBackReference(bool backref) { m_in_backref = backref ; }
       void setMaxBitLength(size_t maxlen)
 	 { if (m_litcodes) m_litcodes->setMaxBitLength(maxlen) ; }
@@ -389,8 +432,6 @@ class HuffmanHypothesis : public Fr::Object
       HuffmanTreeHypothesis* m_distcodes ;
 
       HuffmanHypothesis     *m_next ;
-      HuffmanHypothesis	    *m_dirnext ;
-      HuffmanHypothesis	    *m_dirprev ;
       size_t		     m_bitcount ;
       HuffmanCode	     m_lastliteral ;
       unsigned short	     m_lastlitlength ;
@@ -403,11 +444,31 @@ class HuffmanHypothesis : public Fr::Object
    } ;
 
 
+//----------------------------------------------------------------------
+// limits on the resources which partial-packet searches may consume, either
+//   for each member of an archive or over the whole run; a zero limit is
+//   unlimited
+
+class SearchBudget
+   {
+   public:
+      double	cpu_seconds { 0.0 } ;	// CPU time, summed over all threads
+      size_t	expansions { 0 } ;	// hypotheses expanded
+      size_t	resident_MB { 0 } ;	// member: growth, global: total size
+   } ;
+
 /************************************************************************/
 /************************************************************************/
 
+extern size_t partial_search_beam ;
+extern bool partial_value_search ;
+extern SearchBudget partial_member_budget ;
+extern SearchBudget partial_global_budget ;
+extern void start_partial_search_member() ;
+
 extern bool search(const BitPointer* s, const BitPointer* e, BitPointer* p_hdr, bool deflate64) ;
 extern HuffmanHypothesis *search(const BitPointer* s, const BitPointer* e, const class HuffSymbolTable*) ;
+extern HuffmanHypothesis *search_unknown_trees(const BitPointer* s, const BitPointer* e) ;
 extern void free_hypotheses(class HuffmanHypothesis*) ;
 
 #endif /* !__PARTIAL_H_INCLUDED */
@@ -40,6 +40,17 @@
 #define PTRIE_ROOT_INDEX 0
 #define PTRIE_TERMINAL_MASK 0x80000000
 
+// the order in which the full nodes are stored: as allocated while
+//   converting from a NybbleTrie (each node's children, then each child's
+//   subtree in turn), or with the upper levels breadth-first
+#define PTRIE_LAYOUT_ALLOCATION 0
+#define PTRIE_LAYOUT_LEVELS 1
+
+// the number of bits per quantized frequency which may be requested for the
+//   succinct representation of a trie
+#define PTRIE_QUANTIZE_8BIT 8
+#define PTRIE_QUANTIZE_16BIT 16
+
 /************************************************************************/
 /************************************************************************/
 
@@ -57,16 +68,16 @@ class PackedSimpleTrieNode ;
 class PackedTrieMatch
    {
    public:
-      PackedTrieMatch() { m_node = nullptr ; m_key = nullptr ; m_keylen = 0 ; }
+      PackedTrieMatch() { m_index = PTRIE_ROOT_INDEX ; m_key = nullptr ; m_keylen = 0 ; }
       ~PackedTrieMatch() {}
 
       // accessors
-      const PackedSimpleTrieNode* node() const { return m_node ; }
+      uint32_t index() const { return m_index ; }
       const uint8_t* key() const { return m_key ; }
       unsigned keyLength() const { return m_keylen ; }
 
       // modifiers
-      void setNode(const PackedSimpleTrieNode *n) { m_node = n ; }
+      void setIndex(uint32_t index) { m_index = index ; }
       void setKeyBuffer(uint8_t *buffer, unsigned len)
 	 { m_key = buffer ; m_keylen = len ; } 
       void setKey(uint8_t *newkey, unsigned len)
@@ -76,11 +87,45 @@ class PackedTrieMatch
 	 }
 
    private:
-      const PackedSimpleTrieNode* m_node ;
+      uint32_t			  m_index ;	// node of the matched key
       uint8_t*			  m_key ;
       unsigned			  m_keylen ;
    } ;
 
+//----------------------------------------------------------------------
+//  one of the keys in a batched call to LangIDPackedTrie::enumerate
+
+class PackedTrieQuery
+   {
+   public:
+      PackedTrieQuery() { set(nullptr,0,nullptr,nullptr,0) ; }
+      ~PackedTrieQuery() {}
+
+      // accessors
+      const uint8_t* key() const { return m_key ; }
+      unsigned keyLength() const { return m_keylen ; }
+      const WildcardSet* alternative(unsigned N) const { return m_alternatives[N] ; }
+      PackedTrieMatch* matches() const { return m_matches ; }
+      unsigned maxMatches() const { return m_maxmatches ; }
+      // greater than maxMatches() if there were too many matches to store
+      unsigned numMatches() const { return m_nummatches ; }
+
+      // modifiers
+      void set(const uint8_t* key, unsigned keylen, const WildcardSet** alternatives,
+	       PackedTrieMatch* matches, unsigned max_matches)
+	 { m_key = key ; m_keylen = keylen ; m_alternatives = alternatives ;
+	   m_matches = matches ; m_maxmatches = max_matches ; m_nummatches = 0 ; }
+      void setNumMatches(unsigned count) { m_nummatches = count ; }
+
+   private:
+      const uint8_t*	  m_key ;
+      const WildcardSet** m_alternatives ;
+      PackedTrieMatch*	  m_matches ;
+      unsigned		  m_keylen ;
+      unsigned		  m_maxmatches ;
+      unsigned		  m_nummatches ;
+   } ;
+
 //----------------------------------------------------------------------
 
 class PackedSimpleTrieNode
@@ -121,6 +166,8 @@ class PackedSimpleTrieNode
 			    void *user_data) const ;
       unsigned enumerateMatches(const class EnumerationInfo *info,
 				unsigned keylen) const ;
+      unsigned matchingChildren(const WildcardSet *alternatives,
+				uint32_t *indices, uint8_t *bytes) const ;
       bool nextFrequencies(const LangIDPackedTrie *trie,
 			   uint32_t *frequencies) const ;
       bool addToScores(const LangIDPackedTrie *trie, float *scores,
@@ -157,19 +204,25 @@ class LangIDPackedTrie
 
       // how do we distinguish non-terminal from terminal nodes?
       static constexpr uint32_t TERMINAL_MASK = 0x80000000 ;
+      // how often the succinct form samples the node degree positions
+      static constexpr uint32_t SELECT_SAMPLE = 64 ;
     public:
       LangIDPackedTrie() { init() ; }
-      LangIDPackedTrie(const NybbleTrie* trie, uint32_t min_freq = 1, bool show_conversion = true) ;
+      LangIDPackedTrie(const NybbleTrie* trie, uint32_t min_freq = 1, bool show_conversion = true,
+		       bool relayout_nodes = true) ;
       LangIDPackedTrie(Fr::CFile& f, const char *filename) ;
       ~LangIDPackedTrie() ;
 
       bool parseHeader(Fr::CFile& f) ;
 
       // modifiers
+      bool relayout() ;
+      bool makeSuccinct(unsigned freq_bits) ;
 
       // accessors
       bool good() const
-	 { return m_nodes && m_size > 0 ; }
+	 { return (m_nodes && m_size > 0) || m_louds ; }
+      bool succinct() const { return m_louds != nullptr ; }
       bool terminalNode(const Node *n) const
          { return (n < m_nodes) || (n >= m_nodes + m_size) ; }
       uint32_t size() const { return m_size ; }
@@ -190,6 +243,25 @@ class LangIDPackedTrie
 	 { return &m_nodes[N] ; }
       Node *getTerminalNode(uint32_t N) const
 	 { return (Node*)&m_terminals[N & ~TERMINAL_MASK] ; }
+      // start fetching a node which will be needed shortly, so that the
+      //   cache miss overlaps with work on other keys
+      void prefetch(uint32_t N) const
+	 { if (m_louds)
+	      { if (N < m_numnodes) __builtin_prefetch(&m_selects[N / SELECT_SAMPLE]) ; }
+	   else
+	      { const Node* n = node(N) ; if (n) __builtin_prefetch(n) ; }
+	 }
+      uint32_t nodeIndex(const Node *n) const
+	 { return terminalNode(n) ? (uint32_t)((const TermNode*)n - m_terminals.begin()) | TERMINAL_MASK
+	                          : (uint32_t)(n - m_nodes.begin()) ; }
+
+      // these work on either representation; the Node-based functions
+      //   (node(), findNode(), countMatches(), and the enumerate() which
+      //   passes nodes to its callback) require the packed representation
+      uint32_t frequency(uint32_t N) const ;
+      bool extensible(uint32_t N) const ;
+      bool addToScores(uint32_t N, float *scores, double weight) const ;
+      bool addToScores(uint32_t N, double *scores, double weight) const ;
 
       Node *findNode(const uint8_t *key, unsigned keylength) const ;
       uint32_t find(const uint8_t *key, unsigned keylength) const ;
@@ -208,6 +280,8 @@ class LangIDPackedTrie
 			 PackedTrieMatch *matches,
 			 unsigned max_matches,
 			 bool require_extensible_match) const ;
+      bool enumerate(PackedTrieQuery *queries, unsigned num_queries,
+		     bool require_extensible_match) const ;
 
       // I/O
       static Fr::Owned<LangIDPackedTrie> load(Fr::CFile& f, const char *filename) ;
@@ -224,6 +298,17 @@ class LangIDPackedTrie
 			  unsigned keylen, uint32_t min_freq = 1) ;
       bool insertTerminals(Node *parent, const NybbleTrie *trie, uint32_t node_index,
 			   unsigned keylen, uint32_t min_freq = 1) ;
+      uint32_t placeChildren(uint32_t nodeindex, uint32_t *order, uint32_t placed) const ;
+      uint32_t placeSubtree(uint32_t nodeindex, uint32_t *order, uint32_t placed) const ;
+      unsigned matchingChildren(uint32_t nodeindex, const WildcardSet *alternative, uint8_t keybyte,
+				uint32_t *indices, uint8_t *bytes) const ;
+      bool setSuccinctStorage(uint64_t *storage) ;
+      size_t degreeStart(uint32_t N) const ;
+      void succinctChildren(uint32_t N, uint32_t &first, uint32_t &count) const ;
+      bool succinctTerminal(uint32_t N) const
+	 { return (m_terminalbits[N / 64].load() & (1ULL << (N % 64))) != 0 ; }
+      bool enumerateSuccinct(uint32_t N, uint8_t *keybuf, unsigned keylen, unsigned maxkeylength,
+			     PackedSimpleTrieEnumFn *fn, void *user_data) const ;
    private:
       Fr::NewPtr<Node>   m_nodes ; // array of nodes
       Fr::NewPtr<TermNode> m_terminals ;
@@ -233,6 +318,19 @@ class LangIDPackedTrie
       uint32_t		 m_numterminals ;
       uint32_t		 m_termused ;
       unsigned		 m_maxkeylen ;
+      uint8_t		 m_layout ;	 // PTRIE_LAYOUT_xxx
+      // the read-only succinct representation: the nodes are numbered in
+      //   breadth-first order, each node's degree is stored in unary
+      //   (LOUDS), and the key byte leading to each node and its
+      //   quantized frequency are stored in arrays indexed by node number
+      Fr::NewPtr<uint64_t> m_succinct ;	 // storage for the arrays below
+      const Fr::UInt64*	 m_louds ;	 // unary node degrees
+      const Fr::UInt32*	 m_selects ;	 // start of every SELECT_SAMPLE'th degree
+      const Fr::UInt64*	 m_terminalbits ; // which nodes were terminals
+      const uint8_t*	 m_labels ;	 // key byte leading to each node
+      const uint8_t*	 m_freqcodes ;	 // quantized frequencies, little-endian
+      uint32_t		 m_numnodes ;	 // total nodes in succinct form
+      uint8_t		 m_freqbits ;	 // bits per quantized frequency
    } ;
 
 //----------------------------------------------------------------------
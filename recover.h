@@ -26,6 +26,7 @@
 #ifndef __RECOVER_H_INCLUDED
 #define __RECOVER_H_INCLUDED
 
+#include "extents.h"
 #include "lenmodel.h"
 #include "ziprec.h"
 #include "whatlang2/trie.h"
@@ -34,6 +35,7 @@
 /************************************************************************/
 
 extern size_t blocking_size ;
+extern size_t mapping_budget ;
 
 /************************************************************************/
 /************************************************************************/
@@ -67,6 +69,13 @@ class FileInformation
       FileFormat	  m_format ;
       const char	 *m_bufferstart ;
       const char 	 *m_bufferend ;
+      const DataExtents  *m_extents { nullptr } ;
+      int		  m_mapped_fd { -1 } ; // fd of memory-mapped input, if any
+      off_t		  m_baseoffset { 0 } ; // file offset of m_bufferstart
+      off_t		  m_corestart { 0 } ;  // when processing a window of the
+      off_t		  m_coreend { 0 } ;    //   file, the members it owns
+      off_t		  m_deferred { -1 } ;  // owned member which ran past the window
+      bool		  m_windowed { false } ;
       bool		  m_stdin ;
    public:
       FileInformation(const char *infile, LanguageIdentifier *id,
@@ -80,8 +89,14 @@ class FileInformation
       ~FileInformation() {}
 
       // manipulators
-      void setBuffer(const char *s, const char *e)
-	 { m_bufferstart = s ; m_bufferend = e ; }
+      void setBuffer(const char *s, const char *e, off_t base = 0)
+	 { m_bufferstart = s ; m_bufferend = e ; m_baseoffset = base ; }
+      void setWindowCore(off_t start, off_t end)
+	 { m_corestart = start ; m_coreend = end ; m_windowed = true ; }
+      void clearWindowCore() { m_windowed = false ; m_deferred = -1 ; }
+      void deferMember(off_t offset) { m_deferred = offset ; }
+      void setExtents(const DataExtents *ext) { m_extents = ext ; }
+      void setMappedFile(int fd) { m_mapped_fd = fd ; }
       void usingStdin(bool std) { m_stdin = std ; }
       void replaceOutputDirectory(const char *dir) { m_output_dir = dir ; }
       void restoreOutputDirectory() { m_output_dir = m_orig_output_dir ; }
@@ -95,7 +110,22 @@ class FileInformation
       FileFormat format() const { return m_format ; }
       const char *bufferStart() const { return m_bufferstart ; }
       const char *bufferEnd() const { return m_bufferend ; }
+      const DataExtents *extents() const { return m_extents ; }
       bool usingStdin() const { return m_stdin ; }
+      bool memoryMapped() const { return m_mapped_fd >= 0 ; }
+      off_t baseOffset() const { return m_baseoffset ; }
+      bool inWindowCore(off_t offset) const
+	 { return !m_windowed || (offset >= m_corestart && offset < m_coreend) ; }
+      // does a member whose span ends at 'offset' run off the end of a
+      //   window which is not the last one?
+      bool overrunsWindow(off_t offset) const
+	 { return m_windowed && m_coreend < m_bufferend - m_bufferstart
+	       && offset >= m_bufferend - m_bufferstart ; }
+      off_t deferredMember() const { return m_deferred ; }
+
+      // page-cache management for the span of a single member
+      void prefetch(off_t start, off_t end) const ;
+      void release(off_t start, off_t end) const ;
    } ;
       
 /************************************************************************/
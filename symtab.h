@@ -43,6 +43,7 @@ class HuffSymbolTable
 
       // accessors
       Fr::VarBits getEOD() const { return m_eod ; }
+      bool deflate64() const { return m_deflate64 ; }
       bool nextSymbol(BitPointer& pos, const BitPointer& str_end, HuffSymbol& symbol) const ;
       bool nextValue(BitPointer& pos, const BitPointer& str_end,  HuffSymbol& symbol) const ;
       // skip over the next literal or length/distance pair
@@ -0,0 +1,102 @@
+/****************************** -*- C++ -*- *****************************/
+/*									*/
+/*	ZipRecover: extract text from corrupted zip/gzip streams	*/
+/*	by Ralf Brown / Carnegie Mellon University			*/
+/*									*/
+/*  File: triage.h - fast inventory of recoverable streams		*/
+/*  Version:  1.10beta				       			*/
+/*  LastEdit: 2026-10-18						*/
+/*									*/
+/*  (c) Copyright 2026 Carnegie Mellon University			*/
+/*      This program is free software; you can redistribute it and/or   */
+/*      modify it under the terms of the GNU General Public License as  */
+/*      published by the Free Software Foundation, version 3.           */
+/*                                                                      */
+/*      This program is distributed in the hope that it will be         */
+/*      useful, but WITHOUT ANY WARRANTY; without even the implied      */
+/*      warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR         */
+/*      PURPOSE.  See the GNU General Public License for more details.  */
+/*                                                                      */
+/*      You should have received a copy of the GNU General Public       */
+/*      License (file COPYING) along with this program.  If not, see    */
+/*      http://www.gnu.org/licenses/                                    */
+/*                                                                      */
+/************************************************************************/
+
+#ifndef __TRIAGE_H_INCLUDED
+#define __TRIAGE_H_INCLUDED
+
+#include <cstdio>
+#include <sys/types.h>
+#include "loclist.h"
+#include "framepac/smartptr.h"
+
+/************************************************************************/
+/*	Type definitions						*/
+/************************************************************************/
+
+class FileInformation ;
+
+//----------------------------------------------------------------------
+// an inventory of the members and streams found in the input, written
+//   as tab-separated lines (one per stream) without inflating anything;
+//   streams are queued while the signature list is walked, and the
+//   packet-boundary checks for an entire archive are run in parallel
+//   once all of its streams are known
+
+class TriageReport
+   {
+   public:
+      TriageReport(FILE* out, unsigned threads = 0) ;
+      ~TriageReport() = default ;
+
+      // modifiers
+      void beginArchive(const char* input_file, unsigned seqnum, const char* central_dir) ;
+      void addStream(SignatureType start_type, SignatureType end_type, off_t start, off_t end,
+		     uint32_t original_size, const char* name, bool known_start, bool known_end,
+		     bool deflate64, bool check_packets = true) ;
+      void finishArchive(const FileInformation* fileinfo) ;
+
+      // accessors
+      size_t numStreams() const { return m_count ; }
+
+   protected:
+      struct Entry
+         {
+	 off_t    m_start ;
+	 off_t    m_end ;
+	 size_t   m_name ;		// offset in name pool, or NO_NAME
+	 uint32_t m_original_size ;
+	 unsigned m_packets ;
+	 SignatureType m_start_type ;
+	 SignatureType m_end_type ;
+	 bool     m_known_start ;
+	 bool     m_known_end ;
+	 bool     m_deflate64 ;
+	 bool     m_check_packets ;
+	 bool     m_valid_header ;
+	 } ;
+      static const size_t NO_NAME = ~(size_t)0 ;
+
+      size_t addName(const char* name) ;
+      void checkEntry(Entry& entry, const FileInformation* fileinfo) const ;
+      void writeEntry(const Entry& entry, off_t base_offset) const ;
+      static const char* streamType(SignatureType start_type, SignatureType end_type) ;
+
+   private:
+      FILE*             m_out ;
+      Fr::NewPtr<Entry> m_entries ;
+      Fr::NewPtr<char>  m_names ;
+      Fr::CharPtr       m_input_file ;
+      const char*       m_central_dir { "-" } ;
+      size_t            m_count { 0 } ;
+      size_t            m_alloc { 0 } ;
+      size_t            m_names_used { 0 } ;
+      size_t            m_names_alloc { 0 } ;
+      unsigned          m_seqnum { 0 } ;
+      unsigned          m_threads ;
+   } ;
+
+#endif /* !__TRIAGE_H_INCLUDED */
+
+// end of file triage.h //
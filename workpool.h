@@ -0,0 +1,85 @@
+/****************************** -*- C++ -*- *****************************/
+/*									*/
+/*	ZipRecover: extract text from corrupted zip/gzip streams	*/
+/*	by Ralf Brown / Carnegie Mellon University			*/
+/*									*/
+/*  File: workpool.h - persistent pool of worker threads		*/
+/*  Version:  1.10beta				       			*/
+/*  LastEdit: 2026-10-18						*/
+/*									*/
+/*  (c) Copyright 2026 Carnegie Mellon University			*/
+/*      This program is free software; you can redistribute it and/or   */
+/*      modify it under the terms of the GNU General Public License as  */
+/*      published by the Free Software Foundation, version 3.           */
+/*                                                                      */
+/*      This program is distributed in the hope that it will be         */
+/*      useful, but WITHOUT ANY WARRANTY; without even the implied      */
+/*      warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR         */
+/*      PURPOSE.  See the GNU General Public License for more details.  */
+/*                                                                      */
+/*      You should have received a copy of the GNU General Public       */
+/*      License (file COPYING) along with this program.  If not, see    */
+/*      http://www.gnu.org/licenses/                                    */
+/*                                                                      */
+/************************************************************************/
+
+#ifndef __WORKPOOL_H_INCLUDED
+#define __WORKPOOL_H_INCLUDED
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/************************************************************************/
+/*	Type definitions						*/
+/************************************************************************/
+
+// a set of threads which stay around for the duration of a task made up
+//   of many parallel steps (such as one search, or one round of
+//   inference), so that each step doesn't pay for thread startup
+
+class WorkerPool
+   {
+   public:
+      typedef std::function<void(unsigned)> Task ;
+   public:
+      WorkerPool(unsigned threads) ;
+      ~WorkerPool() ;
+
+      // accessors
+      unsigned size() const { return m_threads ; }
+
+      // run 'task' on every worker, passing it the worker's index; the
+      //   calling thread is worker 0, and run() returns only when all
+      //   workers have finished
+      void run(const Task& task) ;
+
+   protected:
+      void workerLoop(unsigned index) ;
+
+   private:
+      std::unique_ptr<std::thread[]> m_workers ;
+      std::mutex		     m_lock ;
+      std::condition_variable	     m_start ;
+      std::condition_variable	     m_done ;
+      const Task*		     m_task { nullptr } ;
+      uint64_t			     m_generation { 0 } ;
+      unsigned			     m_threads ;
+      unsigned			     m_busy { 0 } ;
+      bool			     m_shutdown { false } ;
+   } ;
+
+
+/************************************************************************/
+/************************************************************************/
+
+// the number of worker threads to use for a parallel task, which is the
+//   number of processors unless limited by 'max_threads' (if nonzero)
+unsigned worker_threads(unsigned max_threads = 0) ;
+
+#endif /* !__WORKPOOL_H_INCLUDED */
+
+// end of file workpool.h //
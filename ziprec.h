@@ -27,6 +27,8 @@
 
 #include "dbyte.h"
 
+class TriageReport ;
+
 class ZipRecParameters
    {
    public: // members
@@ -40,6 +42,7 @@ class ZipRecParameters
       WriteFormat write_format { WFMT_PlainText } ;
 
       mutable const char* base_name { nullptr } ;
+      TriageReport* triage { nullptr } ;	// inventory only, no recovery
 
       bool junk_paths { false } ;
       bool force_overwrite { false } ;